@@ -13,6 +13,12 @@ export interface SpawnerList {
     gimmickSpawners: Spawner[],
     encountSpawners: Spawner[],
 }
+export interface PlayerPosition {
+    x: number,
+    y: number,
+    z: number,
+    yaw: number,
+}
 export namespace API {
     export async function connect(ip: string) {
         return await fetch("/api/connect", {
@@ -51,12 +57,7 @@ export namespace API {
     export async function loadedSpawners() {
         return (await (await fetch("/api/loaded-spawners")).json()) as SpawnerList;
     }
-    export async function playerPosition(): Promise<{
-        x: number,
-        y: number,
-        z: number,
-        yaw: number,
-    }> {
+    export async function playerPosition(): Promise<PlayerPosition> {
         return (await (await fetch("/api/player-position")).json());
     }
 }
\ No newline at end of file
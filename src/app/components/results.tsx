@@ -25,6 +25,14 @@ export interface EncounterSlotTable {
     maxLevel: number,
     slots: EncounterSlot[];
 }
+export interface SpawnArea {
+    player: {
+        x: number,
+        z: number,
+    },
+    spawner: number[],
+    reachRadius: number,
+}
 export interface OverworldSpec {
     species: number,
     form: number,
@@ -44,6 +52,7 @@ export interface OverworldSpec {
     pid: number,
 
     advance: number,
+    origin: number,
 }
 const ResultBody = memo(
     function ResultBody({ results }: { results: JSX.Element[] }) {
@@ -61,6 +70,7 @@ export function ResultsInterface(
         gimmickSpec,
         encounterTable,
         spawnRadius,
+        spawnArea,
     }: {
         initialRngState: BigUint64Array,
         settings: Settings
@@ -68,6 +78,7 @@ export function ResultsInterface(
         gimmickSpec: GimmickSpec | undefined
         encounterTable: EncounterSlotTable | undefined
         spawnRadius: number | undefined
+        spawnArea: SpawnArea | undefined
     }) {
     const isGimmick = settings.encounterType == 0;
     const [currentResults, setCurrentResults] = useState<JSX.Element[]>([]);
@@ -77,7 +88,7 @@ export function ResultsInterface(
         if (tableRef.current && (gimmickSpec || encounterTable)) {
             const results = [];
             // TODO: hidden encounter tables
-            if ((isGimmick && !gimmickSpec) || (!isGimmick && (!encounterTable || !spawnRadius))) {
+            if ((isGimmick && !gimmickSpec) || (!isGimmick && (!encounterTable || !spawnRadius || !spawnArea))) {
                 return;
             }
             const rawResults = isGimmick ? Overworld.generateGimmicks(
@@ -85,7 +96,7 @@ export function ResultsInterface(
                 filters,
                 gimmickSpec as GimmickSpec,
                 initialRngState
-            ) : Overworld.generateSlots(settings, filters, encounterTable as EncounterSlotTable, spawnRadius as number, initialRngState);
+            ) : Overworld.generateSlots(settings, filters, encounterTable as EncounterSlotTable, spawnRadius as number, spawnArea as SpawnArea, initialRngState);
             for (const result of rawResults) {
                 results.push(
                     <tr>
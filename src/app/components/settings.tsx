@@ -1,6 +1,6 @@
 import { useId, useState } from "react";
 import { GENDERS, NATURES, SPECIES, WEATHERS } from "../resources";
-import { Spawner } from "../api";
+import { PlayerPosition, Spawner } from "../api";
 
 export interface Settings {
     minAdvance: number,
@@ -9,6 +9,7 @@ export interface Settings {
     flyCalibration: number,
     rainCalibration: number,
     maximumDistance: number,
+    reachRadius: number,
     tidsid: number,
     hasShinyCharm: boolean,
     hasMarkCharm: boolean,
@@ -26,6 +27,7 @@ export function InfoInterface(
         setSpawner,
         updateSpawners,
         weather,
+        playerPosition,
     }: {
         rngAdvance: number,
         settings: Settings,
@@ -35,6 +37,7 @@ export function InfoInterface(
         setSpawner: (spawner: Spawner | null) => void,
         updateSpawners: () => Promise<void>,
         weather: number
+        playerPosition: PlayerPosition | null
     }
 ) {
     const id = useId();
@@ -194,6 +197,19 @@ export function InfoInterface(
                                 onChange={(e) => setSettings({ ...settings, maximumDistance: parseFloat(e.target.value) })}
                             />
                         </label>
+                        <label
+                            className="flex flex-col md:flex-row items-center gap-2"
+                            title="Spawns further than this from the last polled player position are not shown. 0 disables the check."
+                        >
+                            Reach Radius ({playerPosition ? `around ${playerPosition.x.toFixed(2)}, ${playerPosition.z.toFixed(2)}` : "no position polled yet"}):
+                            <input
+                                type="number"
+                                min={0}
+                                className="w-32 h-8 p-2 border border-gray-300 rounded text-black"
+                                value={settings.reachRadius}
+                                onChange={(e) => setSettings({ ...settings, reachRadius: parseFloat(e.target.value) })}
+                            />
+                        </label>
                     </div>
                 </label>
             </div>
@@ -1,6 +1,6 @@
 'use client';
-import { useRef, useState } from "react";
-import { API, Spawner, SpawnerList } from "./api";
+import { useMemo, useRef, useState } from "react";
+import { API, PlayerPosition, Spawner, SpawnerList } from "./api";
 import { ConnectionInterface } from "./components/connection_interface";
 import { InfoInterface, Settings } from "./components/settings";
 import { FiltersInterface, Filters } from "./components/filters";
@@ -14,6 +14,7 @@ export default function Home() {
     const [rngPointer, setRngPointer] = useState(null as Xoroshiro | null);
     const [fullSpawnerList, setFullSpawnerList] = useState({ gimmickSpawners: [], encountSpawners: [] } as SpawnerList);
     const [spawner, setSpawner] = useState<Spawner | null>(null);
+    const [playerPosition, setPlayerPosition] = useState<PlayerPosition | null>(null);
     const rngPointerRef = useRef<Xoroshiro | null>();
     const loadedSpawnersRef = useRef<Spawner[]>();
     const spawnerRef = useRef<Spawner | null>();
@@ -28,6 +29,7 @@ export default function Home() {
         flyCalibration: 0,
         rainCalibration: 0,
         maximumDistance: 0,
+        reachRadius: 0,
         tidsid: 0,
         hasShinyCharm: false,
         hasMarkCharm: false,
@@ -35,6 +37,13 @@ export default function Home() {
         encounterType: 0,
     })
 
+    // pruning only applies once a real player position has been polled
+    const spawnArea = useMemo(() => spawner ? {
+        player: playerPosition ?? { x: 0, z: 0 },
+        spawner: spawner.position,
+        reachRadius: playerPosition ? settings.reachRadius : 0,
+    } : undefined, [spawner, playerPosition, settings.reachRadius]);
+
     const loadedSpawners = settings.encounterType === 0 ? fullSpawnerList.gimmickSpawners : fullSpawnerList.encountSpawners;
     loadedSpawnersRef.current = loadedSpawners;
     if (spawner == null && loadedSpawners.length > 0) {
@@ -101,10 +110,11 @@ export default function Home() {
         setSettings((settings) => {
             return { ...settings, weather };
         })
+        const playerPosition = await API.playerPosition();
+        setPlayerPosition(playerPosition);
         if (spawnerCanvasRef.current && loadedSpawnersRef.current) {
             const ctx = spawnerCanvasRef.current.getContext("2d");
             if (ctx) {
-                const playerPosition = await API.playerPosition();
                 const center = { x: spawnerCanvasRef.current.width / 2, y: spawnerCanvasRef.current.height / 2 };
                 const scale = spawnerCanvasRef.current.width / 1500;
                 ctx.clearRect(0, 0, spawnerCanvasRef.current.width, spawnerCanvasRef.current.height);
@@ -160,9 +170,9 @@ export default function Home() {
     return (
         <main className="w-full h-screen flex flex-col gap-4 p-4">
             <ConnectionInterface onConnect={onConnect} updateCallback={updateCallback} onDisconnect={onDisconnect} />
-            <InfoInterface weather={settings.weather} setSpawner={setSpawner} updateSpawners={updateSpawners} loadedSpawners={loadedSpawners} spawnerCanvasRef={spawnerCanvasRef} rngAdvance={rngAdvance} settings={settings} setSettings={setSettings} />
+            <InfoInterface weather={settings.weather} playerPosition={playerPosition} setSpawner={setSpawner} updateSpawners={updateSpawners} loadedSpawners={loadedSpawners} spawnerCanvasRef={spawnerCanvasRef} rngAdvance={rngAdvance} settings={settings} setSettings={setSettings} />
             <FiltersInterface filters={filters} setFilters={setFilters} />
-            <ResultsInterface gimmickSpec={spawner?.gimmickSpecs[settings.weather]} spawnRadius={spawner?.spawnRadius} encounterTable={spawner?.encounterSlotTables[settings.weather]} initialRngState={initialRngState} filters={filters} settings={settings} />
+            <ResultsInterface gimmickSpec={spawner?.gimmickSpecs[settings.weather]} spawnRadius={spawner?.spawnRadius} spawnArea={spawnArea} encounterTable={spawner?.encounterSlotTables[settings.weather]} initialRngState={initialRngState} filters={filters} settings={settings} />
         </main>
     );
 }
@@ -1,10 +1,15 @@
 import { WASI } from "@wasmer/wasi";
 import wasiBindings from "@wasmer/wasi/lib/bindings/browser";
 import { WasmFs } from "@wasmer/wasmfs";
-import { OverworldSpec, GimmickSpec, EncounterSlotTable } from './components/results';
+import { OverworldSpec, GimmickSpec, EncounterSlotTable, SpawnArea } from './components/results';
 import { Settings } from "./components/settings";
 import { Filters } from "./components/filters";
 
+export interface BatchResults {
+    results: OverworldSpec[],
+    truncatedOrigins: number[],
+}
+
 interface Library {
     deleteBytes(address: number): void;
     allocateBytes(size: number): number;
@@ -12,8 +17,27 @@ interface Library {
     xoroshiro(rngState: number): number;
     xoroshiroUpdate(rng: number, rngState: number): number;
 
-    generateSlots(settings: number, filters: number, slotTable: number, spawnRadius: number, rng: number): number;
+    generateSlots(settings: number, filters: number, slotTable: number, spawnRadius: number, spawnArea: number, rng: number): number;
     generateGimmicks(settings: number, filters: number, gimmickSpec: number, rng: number): number;
+    generateSlotsBatch(settings: number, filters: number, slotTable: number, spawnRadius: number, spawnArea: number, rngs: number, tidsids: number, originCount: number, maximumResultsPerOrigin: number): number;
+    generateGimmicksBatch(settings: number, filters: number, gimmickSpec: number, rngs: number, tidsids: number, originCount: number, maximumResultsPerOrigin: number): number;
+    estimateSlots(settings: number, filters: number, slotTable: number, spawnRadius: number, spawnArea: number, rng: number): number;
+    estimateGimmicks(settings: number, filters: number, gimmickSpec: number, rng: number): number;
+}
+
+export interface SearchEstimate {
+    sampledAdvances: number,
+    sampledHits: number,
+    hitDensity: number,
+    hitDensityLow: number,
+    hitDensityHigh: number,
+    expectedResults: number,
+    expectedResultsLow: number,
+    expectedResultsHigh: number,
+    expectedBytes: number,
+    expectedBytesHigh: number,
+    secondsPerAdvance: number,
+    projectedSeconds: number,
 }
 
 let wasmfs: WasmFs;
@@ -90,12 +114,13 @@ export class Xoroshiro extends Pointer {
 }
 
 export namespace Overworld {
-    export function generateSlots(settings: Settings, filters: Filters, slotTable: EncounterSlotTable, spawnRadius: number, initialRngState: BigUint64Array): OverworldSpec[] {
+    export function generateSlots(settings: Settings, filters: Filters, slotTable: EncounterSlotTable, spawnRadius: number, spawnArea: SpawnArea, initialRngState: BigUint64Array): OverworldSpec[] {
         return JSON.parse(new Pointer(wasmExports.generateSlots(
             Pointer.allocateJSON(settings).address,
             Pointer.allocateJSON(filters).address,
             Pointer.allocateJSON(slotTable).address,
             spawnRadius,
+            Pointer.allocateJSON(spawnArea).address,
             Pointer.allocateArrayBuffer(initialRngState.buffer).address
         )).readString());
     }
@@ -107,4 +132,60 @@ export namespace Overworld {
             Pointer.allocateArrayBuffer(initialRngState.buffer).address
         )).readString());
     }
+    export function estimateSlots(settings: Settings, filters: Filters, slotTable: EncounterSlotTable, spawnRadius: number, spawnArea: SpawnArea, initialRngState: BigUint64Array): SearchEstimate {
+        return JSON.parse(new Pointer(wasmExports.estimateSlots(
+            Pointer.allocateJSON(settings).address,
+            Pointer.allocateJSON(filters).address,
+            Pointer.allocateJSON(slotTable).address,
+            spawnRadius,
+            Pointer.allocateJSON(spawnArea).address,
+            Pointer.allocateArrayBuffer(initialRngState.buffer).address
+        )).readString());
+    }
+    export function estimateGimmicks(settings: Settings, filters: Filters, gimmickSpec: GimmickSpec, initialRngState: BigUint64Array): SearchEstimate {
+        return JSON.parse(new Pointer(wasmExports.estimateGimmicks(
+            Pointer.allocateJSON(settings).address,
+            Pointer.allocateJSON(filters).address,
+            Pointer.allocateJSON(gimmickSpec).address,
+            Pointer.allocateArrayBuffer(initialRngState.buffer).address
+        )).readString());
+    }
+    // batch searches keep at most this many results per origin
+    export const BATCH_RESULT_LIMIT = 10000;
+
+    function checkBatchOrigins(initialRngStates: BigUint64Array, tidsids: Uint32Array) {
+        if (initialRngStates.length !== 2 * tidsids.length) {
+            throw new Error(`Expected ${2 * tidsids.length} rng state words for ${tidsids.length} origins, got ${initialRngStates.length}`);
+        }
+    }
+    // initialRngStates holds two u64s per origin, tidsids one u32 per origin
+    // origins are searched one after another in a single call, to use several cores split the origins across
+    // workers that each load their own module
+    // every origin is searched; origins that hit maximumResultsPerOrigin are listed in truncatedOrigins
+    export function generateSlotsBatch(settings: Settings, filters: Filters, slotTable: EncounterSlotTable, spawnRadius: number, spawnArea: SpawnArea, initialRngStates: BigUint64Array, tidsids: Uint32Array, maximumResultsPerOrigin: number = BATCH_RESULT_LIMIT): BatchResults {
+        checkBatchOrigins(initialRngStates, tidsids);
+        return JSON.parse(new Pointer(wasmExports.generateSlotsBatch(
+            Pointer.allocateJSON(settings).address,
+            Pointer.allocateJSON(filters).address,
+            Pointer.allocateJSON(slotTable).address,
+            spawnRadius,
+            Pointer.allocateJSON(spawnArea).address,
+            Pointer.allocateArrayBuffer(initialRngStates.buffer).address,
+            Pointer.allocateArrayBuffer(tidsids.buffer).address,
+            tidsids.length,
+            maximumResultsPerOrigin
+        )).readString());
+    }
+    export function generateGimmicksBatch(settings: Settings, filters: Filters, gimmickSpec: GimmickSpec, initialRngStates: BigUint64Array, tidsids: Uint32Array, maximumResultsPerOrigin: number = BATCH_RESULT_LIMIT): BatchResults {
+        checkBatchOrigins(initialRngStates, tidsids);
+        return JSON.parse(new Pointer(wasmExports.generateGimmicksBatch(
+            Pointer.allocateJSON(settings).address,
+            Pointer.allocateJSON(filters).address,
+            Pointer.allocateJSON(gimmickSpec).address,
+            Pointer.allocateArrayBuffer(initialRngStates.buffer).address,
+            Pointer.allocateArrayBuffer(tidsids.buffer).address,
+            tidsids.length,
+            maximumResultsPerOrigin
+        )).readString());
+    }
 }
\ No newline at end of file
@@ -1,4 +1,7 @@
 #pragma once
+#include <algorithm>
+#include <chrono>
+#include <math.h>
 #include <optional>
 #include "util.hpp"
 #include "types.h"
@@ -132,6 +135,7 @@ typedef struct OverworldSpec {
 
     u8 slot = 10;
     u32 advance = -1;
+    u32 origin = 0;
 
     nlohmann::json toJSON() const {
         nlohmann::json j;
@@ -159,6 +163,7 @@ typedef struct OverworldSpec {
 
         j["slot"] = slot;
         j["advance"] = advance;
+        j["origin"] = origin;
         return j;
     }
 } OverworldSpec;
@@ -251,6 +256,53 @@ typedef struct GimmickSpec {
     }
 } GimmickSpec;
 
+// player and spawner positions on the xz plane along with how far from the player a spawn may be placed
+// used to reject spawns the player could never reach as soon as their placement is known
+typedef struct SpawnArea {
+    float offsetX = 0.0;
+    float offsetZ = 0.0;
+    float reachRadius = 0.0;
+    float furthestSpawn = 0.0;
+
+    SpawnArea(const char* json, const float spawnRadius) {
+        nlohmann::json j = nlohmann::json::parse(json);
+        // player is as returned by /api/player-position, spawner is a spawner's position from /api/loaded-spawners
+        float playerX = j["player"]["x"];
+        float playerZ = j["player"]["z"];
+        float spawnerX = j["spawner"][0];
+        float spawnerZ = j["spawner"][2];
+        offsetX = spawnerX - playerX;
+        offsetZ = spawnerZ - playerZ;
+        reachRadius = j["reachRadius"];
+        furthestSpawn = sqrtf(offsetX * offsetX + offsetZ * offsetZ) + spawnRadius;
+    }
+
+    // a reach radius of 0 disables the check
+    // as does the whole spawn radius already being within reach
+    bool isEnabled() const {
+        return reachRadius > 0.0f && furthestSpawn > reachRadius;
+    }
+
+    // which axis rotation is measured from and in which direction has not been confirmed against the game
+    // so a spawn is only rejected when it is out of reach under every axis-aligned convention:
+    // 0 degrees along +x, -x, +z or -z, turning either way
+    // those 8 candidate directions are (+-sin, +-cos) and (+-cos, +-sin), so the closest candidate to the
+    // player is the one pointing most against the spawner's offset from the player
+    bool isReachable(const float rotation, const float distance) const {
+        if (!isEnabled()) {
+            return true;
+        }
+        float radians = rotation * (M_PI / 180.0f);
+        float s = fabsf(sinf(radians));
+        float c = fabsf(cosf(radians));
+        float x = fabsf(offsetX);
+        float z = fabsf(offsetZ);
+        float towardsPlayer = fmaxf(x * s + z * c, x * c + z * s);
+        float closest = offsetX * offsetX + offsetZ * offsetZ + distance * distance - 2.0f * distance * towardsPlayer;
+        return closest <= reachRadius * reachRadius;
+    }
+} SpawnArea;
+
 typedef struct EncounterSlot {
     u16 species;
     u8 form;
@@ -435,13 +487,16 @@ void generateFullSpec(const Settings &settings, const EncounterSlotTable &slotTa
     // level forced to 60 here (WK_SCENE_MAIN_MASTER)
 }
 
-std::optional<OverworldSpec> generateSlotEncount(const Settings &settings, const EncounterSlotTable &slotTable, const float spawnRadius, Xoroshiro &rng) {
+std::optional<OverworldSpec> generateSlotEncount(const Settings &settings, const EncounterSlotTable &slotTable, const float spawnRadius, const SpawnArea &spawnArea, Xoroshiro &rng) {
     OverworldSpec spec;
     if (settings.encounterType == EncounterType::Symbol) {
         // placement happens before generation for symbols
         // rejects with similar conditions to hiddens but is unimplemented
         spec.rotation = rng.randMax<361>();
         spec.distance = rng.randFloat(spawnRadius);
+        if (!spawnArea.isReachable(spec.rotation, spec.distance)) {
+            return std::nullopt;
+        }
     }
     handleLeadAbility(rng);
     if (settings.encounterType == EncounterType::Hidden) {
@@ -471,6 +526,9 @@ std::optional<OverworldSpec> generateSlotEncount(const Settings &settings, const
         if (spec.distance > settings.maximumDistance) {
             return std::nullopt;
         }
+        if (!spawnArea.isReachable(spec.rotation, spec.distance)) {
+            return std::nullopt;
+        }
         // traditional rotation
         rng.randMax<361>();
         // a few ticks pass potentially letting noise advance the rng
@@ -531,61 +589,278 @@ bool preGenerationAdvances(const Settings &settings, Xoroshiro &rng) {
     return true;
 }
 
-// TODO: DRY?
+// generates the encounter for a single advance, returning it only if it exists and passes the filters
+// shared by the searches and the estimators so that estimates cannot drift from what a search returns
+template<typename Generator>
+std::optional<OverworldSpec> generateFilteredAdvance(const Settings &settings, const Filters &filters, const Xoroshiro &rng, const u32 advance, Generator generate) {
+    Xoroshiro go(rng.state[0], rng.state[1]);
+    if (!preGenerationAdvances(settings, go)) {
+        return std::nullopt;
+    }
+    std::optional<OverworldSpec> result = generate(go);
+    if (!result) {
+        return std::nullopt;
+    }
+    result->advance = advance;
+    if (!filters.isValid(*result)) {
+        return std::nullopt;
+    }
+    return result;
+}
 
-std::vector<OverworldSpec> generateGimmickResults(const Settings &settings, const Filters &filters, const GimmickSpec &gimmickSpec, const Xoroshiro &mainRng) {
+// stops searching once maximumResults hits have been found
+template<typename Generator>
+std::vector<OverworldSpec> generateResults(const Settings &settings, const Filters &filters, const Xoroshiro &mainRng, const u32 maximumResults, Generator generate) {
     Xoroshiro rng(mainRng.state[0], mainRng.state[1]);
     std::vector<OverworldSpec> results;
     rng.advance(settings.minAdvance);
-    for (int i = 0; i < settings.totalAdvances; i++) {
-        Xoroshiro go(rng.state[0], rng.state[1]);
-        if (preGenerationAdvances(settings, go)) {
-            auto result = generateGimmickEncount(settings, gimmickSpec, go);
-            result.advance = settings.minAdvance + i;
-            if (filters.isValid(result)) {
-                results.push_back(result);
-            }
+    for (u32 i = 0; i < settings.totalAdvances && results.size() < maximumResults; i++) {
+        auto result = generateFilteredAdvance(settings, filters, rng, settings.minAdvance + i, generate);
+        if (result) {
+            results.push_back(*result);
         }
         rng.next();
     }
     return results;
 }
 
-std::vector<OverworldSpec> generateSlotResults(const Settings &settings, const Filters &filters, const EncounterSlotTable &slotTable, const float spawnRadius, const Xoroshiro &mainRng) {
-    Xoroshiro rng(mainRng.state[0], mainRng.state[1]);
+std::vector<OverworldSpec> generateGimmickResults(const Settings &settings, const Filters &filters, const GimmickSpec &gimmickSpec, const Xoroshiro &mainRng, const u32 maximumResults = -1) {
+    return generateResults(settings, filters, mainRng, maximumResults, [&](Xoroshiro &go) {
+        return std::optional<OverworldSpec>(generateGimmickEncount(settings, gimmickSpec, go));
+    });
+}
+
+std::vector<OverworldSpec> generateSlotResults(const Settings &settings, const Filters &filters, const EncounterSlotTable &slotTable, const float spawnRadius, const SpawnArea &spawnArea, const Xoroshiro &mainRng, const u32 maximumResults = -1) {
+    return generateResults(settings, filters, mainRng, maximumResults, [&](Xoroshiro &go) {
+        return generateSlotEncount(settings, slotTable, spawnRadius, spawnArea, go);
+    });
+}
+
+typedef struct BatchResults {
     std::vector<OverworldSpec> results;
-    rng.advance(settings.minAdvance);
-    for (int i = 0; i < settings.totalAdvances; i++) {
-        Xoroshiro go(rng.state[0], rng.state[1]);
-        if (preGenerationAdvances(settings, go)) {
-            auto result = generateSlotEncount(settings, slotTable, spawnRadius, go);
-            if (result) {
-                auto encount = *result;
-                encount.advance = settings.minAdvance + i;
-                if (filters.isValid(encount)) {
-                    results.push_back(encount);
-                }
-            }
+    // origins whose search stopped at the per origin result limit before reaching the end of the window
+    std::vector<u32> truncatedOrigins;
+
+    nlohmann::json toJSON() const {
+        nlohmann::json j;
+        j["results"] = nlohmann::json::array();
+        for (const auto &result : results) {
+            j["results"].push_back(result.toJSON());
         }
-        rng.next();
+        j["truncatedOrigins"] = truncatedOrigins;
+        return j;
     }
-    return results;
+} BatchResults;
+
+// runs search(settings, rng, limit) once per origin, each with its own initial rng state and tidsid
+// origins are searched one after another on the calling thread, this only saves the per call setup;
+// spreading origins over cores is left to the caller (e.g. one module instance per worker)
+// every origin is searched but keeps at most maximumResultsPerOrigin hits, origins that had more are listed in truncatedOrigins
+// results are tagged with the index of the origin they came from
+template<typename Search>
+BatchResults generateBatchResults(const Settings &settings, const u64* initialRngStates, const u32* tidsids, const u32 originCount, const u32 maximumResultsPerOrigin, Search search) {
+    BatchResults batch;
+    Settings originSettings = settings;
+    // search for one extra hit to tell a truncated origin apart from one with exactly the limit
+    u32 searchLimit = maximumResultsPerOrigin == static_cast<u32>(-1) ? maximumResultsPerOrigin : maximumResultsPerOrigin + 1;
+    for (u32 origin = 0; origin < originCount; origin++) {
+        originSettings.tidsid = tidsids[origin];
+        Xoroshiro rng(initialRngStates[origin * 2], initialRngStates[origin * 2 + 1]);
+        std::vector<OverworldSpec> originResults = search(originSettings, rng, searchLimit);
+        if (originResults.size() > maximumResultsPerOrigin) {
+            originResults.pop_back();
+            batch.truncatedOrigins.push_back(origin);
+        }
+        for (auto &result : originResults) {
+            result.origin = origin;
+        }
+        batch.results.insert(batch.results.end(), std::make_move_iterator(originResults.begin()), std::make_move_iterator(originResults.end()));
+    }
+    return batch;
 }
 
-char* serializeOverworldSpecs(const std::vector<OverworldSpec> &specs) {
+std::string serializeOverworldSpecsJSON(const std::vector<OverworldSpec> &specs) {
     nlohmann::json j = nlohmann::json::array();
     for (const auto &spec : specs) {
         j.push_back(spec.toJSON());
     }
-    return allocateStr(j.dump().c_str());
+    return j.dump();
+}
+
+char* serializeOverworldSpecs(const std::vector<OverworldSpec> &specs) {
+    return allocateStr(serializeOverworldSpecsJSON(specs).c_str());
+}
+
+// number of evenly spaced advances generated by the search estimators
+constexpr u32 ESTIMATE_SAMPLES = 4096;
+// browsers coarsen the clock behind clock_time_get to 0.1-1ms, so every timed phase is repeated for at least this long
+constexpr double ESTIMATE_MIN_SECONDS = 0.02;
+// rng steps per repeat when timing the walk through the search window
+constexpr u32 ESTIMATE_WALK_STEPS = 1 << 16;
+// z score of the 95% confidence interval reported by the estimators
+constexpr double ESTIMATE_Z = 1.96;
+
+typedef struct SearchEstimate {
+    u32 sampledAdvances = 0;
+    u32 sampledHits = 0;
+    double hitDensity = 0.0;
+    double hitDensityLow = 0.0;
+    double hitDensityHigh = 0.0;
+    u64 expectedResults = 0;
+    u64 expectedResultsLow = 0;
+    u64 expectedResultsHigh = 0;
+    u64 expectedBytes = 2;
+    u64 expectedBytesHigh = 2;
+    double secondsPerAdvance = 0.0;
+    double projectedSeconds = 0.0;
+
+    nlohmann::json toJSON() const {
+        nlohmann::json j;
+        j["sampledAdvances"] = sampledAdvances;
+        j["sampledHits"] = sampledHits;
+        j["hitDensity"] = hitDensity;
+        j["hitDensityLow"] = hitDensityLow;
+        j["hitDensityHigh"] = hitDensityHigh;
+        j["expectedResults"] = expectedResults;
+        j["expectedResultsLow"] = expectedResultsLow;
+        j["expectedResultsHigh"] = expectedResultsHigh;
+        j["expectedBytes"] = expectedBytes;
+        j["expectedBytesHigh"] = expectedBytesHigh;
+        j["secondsPerAdvance"] = secondsPerAdvance;
+        j["projectedSeconds"] = projectedSeconds;
+        return j;
+    }
+} SearchEstimate;
+
+// runs body repeatedly until ESTIMATE_MIN_SECONDS have passed and returns the average seconds per run
+template<typename Body>
+double timeRepeated(Body body) {
+    u32 repeats = 0;
+    auto start = std::chrono::steady_clock::now();
+    std::chrono::duration<double> elapsed;
+    do {
+        body();
+        repeats++;
+        elapsed = std::chrono::steady_clock::now() - start;
+    } while (elapsed.count() < ESTIMATE_MIN_SECONDS);
+    return elapsed.count() / repeats;
 }
 
-export char* generateSlots(const char* js_settings, const char* js_filters, const char* js_slotTable, const float spawnRadius, const u64* initialRngState) {
+// runs the real per-advance generation + filters on a sample of the search window and extrapolates to the full window
+// the expected results come with a 95% (wilson score) interval, so a filter too rare to show up in the sample
+// still reports an upper bound instead of a flat 0
+// projectedSeconds covers everything the real search pays for: walking the rng to and through the window,
+// generating every advance and serializing the expected hits
+template<typename Generator>
+SearchEstimate estimateResults(const Settings &settings, const Filters &filters, const Xoroshiro &mainRng, Generator generate) {
+    SearchEstimate estimate;
+    if (settings.totalAdvances == 0) {
+        return estimate;
+    }
+    u32 sampleCount = settings.totalAdvances < ESTIMATE_SAMPLES ? settings.totalAdvances : ESTIMATE_SAMPLES;
+
+    // seek to every sampled advance up front so that generation can be timed on its own
+    // sample i sits at offset i * totalAdvances / sampleCount, spreading the samples over the whole window
+    std::vector<Xoroshiro> samples;
+    std::vector<u32> advances;
+    samples.reserve(sampleCount);
+    advances.reserve(sampleCount);
+    Xoroshiro rng(mainRng.state[0], mainRng.state[1]);
+    rng.advance(settings.minAdvance);
+    u32 offset = 0;
+    for (u32 i = 0; i < sampleCount; i++) {
+        u32 nextOffset = static_cast<u64>(i) * settings.totalAdvances / sampleCount;
+        rng.advance(nextOffset - offset);
+        offset = nextOffset;
+        samples.push_back(rng);
+        advances.push_back(settings.minAdvance + offset);
+    }
+
+    Xoroshiro walker(mainRng.state[0], mainRng.state[1]);
+    double walkSeconds = timeRepeated([&]() {
+        walker.advance(ESTIMATE_WALK_STEPS);
+    });
+    // keep the timed walk from being optimized out
+    volatile u64 walked = walker.state[0];
+    (void)walked;
+
+    std::vector<OverworldSpec> hits;
+    double generateSeconds = timeRepeated([&]() {
+        hits.clear();
+        for (u32 i = 0; i < sampleCount; i++) {
+            auto result = generateFilteredAdvance(settings, filters, samples[i], advances[i], generate);
+            if (result) {
+                hits.push_back(*result);
+            }
+        }
+    });
+
+    // serialize the sampled hits the same way the real search does
+    // with no sampled hits a placeholder stands in to size a single result
+    std::vector<OverworldSpec> serialized = hits;
+    if (serialized.empty()) {
+        OverworldSpec placeholder;
+        placeholder.advance = settings.minAdvance + settings.totalAdvances - 1;
+        serialized.push_back(placeholder);
+    }
+    size_t serializedBytes = 0;
+    double serializeSeconds = timeRepeated([&]() {
+        serializedBytes = serializeOverworldSpecsJSON(serialized).size();
+    });
+    // every result is followed by a comma except the last, the extra byte rounds the estimate up
+    double bytesPerHit = (serializedBytes - 1.0) / serialized.size();
+    double serializeSecondsPerHit = serializeSeconds / serialized.size();
+
+    estimate.sampledAdvances = sampleCount;
+    estimate.sampledHits = hits.size();
+    estimate.hitDensity = static_cast<double>(estimate.sampledHits) / sampleCount;
+    if (sampleCount == settings.totalAdvances) {
+        // the whole window was generated, nothing to extrapolate
+        estimate.hitDensityLow = estimate.hitDensity;
+        estimate.hitDensityHigh = estimate.hitDensity;
+    } else {
+        double n = sampleCount;
+        double p = estimate.hitDensity;
+        double z2 = ESTIMATE_Z * ESTIMATE_Z;
+        double center = (p + z2 / (2.0 * n)) / (1.0 + z2 / n);
+        double halfWidth = ESTIMATE_Z * sqrt(p * (1.0 - p) / n + z2 / (4.0 * n * n)) / (1.0 + z2 / n);
+        estimate.hitDensityLow = fmax(0.0, center - halfWidth);
+        estimate.hitDensityHigh = fmin(1.0, center + halfWidth);
+    }
+    estimate.expectedResults = static_cast<u64>(estimate.hitDensity * settings.totalAdvances + 0.5);
+    estimate.expectedResultsLow = static_cast<u64>(floor(estimate.hitDensityLow * settings.totalAdvances));
+    estimate.expectedResultsHigh = static_cast<u64>(ceil(estimate.hitDensityHigh * settings.totalAdvances));
+    estimate.expectedBytes = 2 + static_cast<u64>(ceil(bytesPerHit * estimate.expectedResults));
+    estimate.expectedBytesHigh = 2 + static_cast<u64>(ceil(bytesPerHit * estimate.expectedResultsHigh));
+
+    // the real search walks minAdvance + totalAdvances steps
+    double projectedWalk = walkSeconds / ESTIMATE_WALK_STEPS * (static_cast<double>(settings.minAdvance) + settings.totalAdvances);
+    double projectedGenerate = generateSeconds / sampleCount * settings.totalAdvances;
+    double projectedSerialize = serializeSecondsPerHit * estimate.expectedResults;
+    estimate.projectedSeconds = projectedWalk + projectedGenerate + projectedSerialize;
+    estimate.secondsPerAdvance = estimate.projectedSeconds / settings.totalAdvances;
+    return estimate;
+}
+
+SearchEstimate estimateSlotResults(const Settings &settings, const Filters &filters, const EncounterSlotTable &slotTable, const float spawnRadius, const SpawnArea &spawnArea, const Xoroshiro &mainRng) {
+    return estimateResults(settings, filters, mainRng, [&](Xoroshiro &go) {
+        return generateSlotEncount(settings, slotTable, spawnRadius, spawnArea, go);
+    });
+}
+
+SearchEstimate estimateGimmickResults(const Settings &settings, const Filters &filters, const GimmickSpec &gimmickSpec, const Xoroshiro &mainRng) {
+    return estimateResults(settings, filters, mainRng, [&](Xoroshiro &go) {
+        return std::optional<OverworldSpec>(generateGimmickEncount(settings, gimmickSpec, go));
+    });
+}
+
+export char* generateSlots(const char* js_settings, const char* js_filters, const char* js_slotTable, const float spawnRadius, const char* js_spawnArea, const u64* initialRngState) {
     Settings settings(js_settings);
     Filters filters(js_filters);
     EncounterSlotTable slotTable(js_slotTable);
+    SpawnArea spawnArea(js_spawnArea, spawnRadius);
     Xoroshiro rng(initialRngState[0], initialRngState[1]);
-    std::vector<OverworldSpec> results = generateSlotResults(settings, filters, slotTable, spawnRadius, rng);
+    std::vector<OverworldSpec> results = generateSlotResults(settings, filters, slotTable, spawnRadius, spawnArea, rng);
     return serializeOverworldSpecs(results);
 }
 
@@ -596,4 +871,44 @@ export char* generateGimmicks(const char* js_settings, const char* js_filters, c
     Xoroshiro rng(initialRngState[0], initialRngState[1]);
     std::vector<OverworldSpec> results = generateGimmickResults(settings, filters, gimmickSpec, rng);
     return serializeOverworldSpecs(results);
+}
+
+export char* estimateSlots(const char* js_settings, const char* js_filters, const char* js_slotTable, const float spawnRadius, const char* js_spawnArea, const u64* initialRngState) {
+    Settings settings(js_settings);
+    Filters filters(js_filters);
+    EncounterSlotTable slotTable(js_slotTable);
+    SpawnArea spawnArea(js_spawnArea, spawnRadius);
+    Xoroshiro rng(initialRngState[0], initialRngState[1]);
+    SearchEstimate estimate = estimateSlotResults(settings, filters, slotTable, spawnRadius, spawnArea, rng);
+    return allocateStr(estimate.toJSON().dump().c_str());
+}
+
+export char* estimateGimmicks(const char* js_settings, const char* js_filters, const char* js_gimmickSpec, const u64* initialRngState) {
+    Settings settings(js_settings);
+    Filters filters(js_filters);
+    GimmickSpec gimmickSpec(js_gimmickSpec);
+    Xoroshiro rng(initialRngState[0], initialRngState[1]);
+    SearchEstimate estimate = estimateGimmickResults(settings, filters, gimmickSpec, rng);
+    return allocateStr(estimate.toJSON().dump().c_str());
+}
+
+export char* generateSlotsBatch(const char* js_settings, const char* js_filters, const char* js_slotTable, const float spawnRadius, const char* js_spawnArea, const u64* initialRngStates, const u32* tidsids, const u32 originCount, const u32 maximumResultsPerOrigin) {
+    Settings settings(js_settings);
+    Filters filters(js_filters);
+    EncounterSlotTable slotTable(js_slotTable);
+    SpawnArea spawnArea(js_spawnArea, spawnRadius);
+    BatchResults batch = generateBatchResults(settings, initialRngStates, tidsids, originCount, maximumResultsPerOrigin, [&](const Settings &originSettings, const Xoroshiro &rng, const u32 limit) {
+        return generateSlotResults(originSettings, filters, slotTable, spawnRadius, spawnArea, rng, limit);
+    });
+    return allocateStr(batch.toJSON().dump().c_str());
+}
+
+export char* generateGimmicksBatch(const char* js_settings, const char* js_filters, const char* js_gimmickSpec, const u64* initialRngStates, const u32* tidsids, const u32 originCount, const u32 maximumResultsPerOrigin) {
+    Settings settings(js_settings);
+    Filters filters(js_filters);
+    GimmickSpec gimmickSpec(js_gimmickSpec);
+    BatchResults batch = generateBatchResults(settings, initialRngStates, tidsids, originCount, maximumResultsPerOrigin, [&](const Settings &originSettings, const Xoroshiro &rng, const u32 limit) {
+        return generateGimmickResults(originSettings, filters, gimmickSpec, rng, limit);
+    });
+    return allocateStr(batch.toJSON().dump().c_str());
 }
\ No newline at end of file